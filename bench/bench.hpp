@@ -0,0 +1,53 @@
+/// /bench.hpp -- micro benchmark harness
+
+/// Author: Zhang Yichao <echaozh@gmail.com>
+/// Created: 2026-10-19
+///
+
+#ifndef INCLUDED_CPPA_RAFT_BENCH_HPP
+#define INCLUDED_CPPA_RAFT_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// results go to stdout as csv, one line per benchmark, so runs from
+// different releases can be diffed or loaded by a script
+static inline void print_header() {
+    std::cout << "name,param,iterations,runs,min_ns_per_op,median_ns_per_op"
+              << std::endl;
+}
+
+// run f iterations times per run, and report the best & the median run
+template <typename F>
+void measure(const std::string& name, uint64_t param, size_t iterations,
+             F f, size_t runs = 5) {
+    using namespace std::chrono;
+    std::vector<double> per_op;
+    for(size_t r = 0; r < runs; ++r) {
+        auto start = steady_clock::now();
+        for(size_t i = 0; i < iterations; ++i)
+            f(i);
+        auto ns = duration_cast<nanoseconds>(steady_clock::now() - start);
+        per_op.push_back((double) ns.count() / iterations);
+    }
+    std::sort(begin(per_op), end(per_op));
+    std::cout << name << "," << param << "," << iterations << "," << runs
+              << "," << per_op.front() << "," << per_op[runs / 2]
+              << std::endl;
+}
+
+struct bench_log_entry {
+    uint64_t term;
+};
+static inline bool operator==(bench_log_entry lhs, bench_log_entry rhs) {
+    return lhs.term == rhs.term;
+}
+
+// keeps results alive so the optimizer can't throw the work away
+static volatile uint64_t bench_sink;
+
+#endif // INCLUDED_CPPA_RAFT_BENCH_HPP
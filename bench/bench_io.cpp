@@ -0,0 +1,139 @@
+/// /bench_io.cpp -- heartbeat jitter under disk load
+
+/// Author: Zhang Yichao <echaozh@gmail.com>
+/// Created: 2026-10-19
+///
+
+// usage: bench_io [scheduler threads] [i/o threads] [followers] [disk ms]
+//
+// a heartbeat actor ticks every 10ms while followers are flooded with
+// appends whose storage sleeps for a while.  run once with storage on the
+// scheduler workers, once with it on an io_pool, and report how late the
+// ticks are.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "follower.hpp"
+#include "io_pool.hpp"
+#include "raft.hpp"
+
+#include "bench.hpp"
+
+using namespace std;
+using namespace std::chrono;
+using namespace cppa;
+
+static const milliseconds tick(10);
+static const size_t ticks = 300;
+
+struct follower_box {
+    raft_config<bench_log_entry> config;
+    raft_state state;
+};
+
+static void heartbeat(shared_ptr<vector<int64_t> > lateness) {
+    auto last = make_shared<steady_clock::time_point>(steady_clock::now());
+    become(
+        after(tick) >> [=]() {
+            auto now = steady_clock::now();
+            auto late = duration_cast<microseconds>(now - *last - tick);
+            lateness->push_back(max<int64_t>(late.count(), 0));
+            *last = now;
+            if(lateness->size() == ticks)
+                self->quit();
+        });
+}
+
+// plays the leader, keeping one append in flight until told to stop
+static void flood(actor_ptr raft, uint16_t port) {
+    send(raft, atom("address"), string("localhost"), port);
+    auto next = [=]() {
+        send(raft, append_request<bench_log_entry> {
+                1, 0, 0, 0, vector<bench_log_entry>(8, {1})});
+    };
+    next();
+    become(
+        on_arg_match >> [=](append_response) {next();},
+        on(atom("stop")) >> [=]() {
+            send(raft, atom("EXIT"), exit_reason::user_shutdown);
+            self->quit();
+        });
+}
+
+static void run(const char* mode, size_t sched_threads,
+                shared_ptr<io_pool> io, size_t followers, milliseconds disk) {
+    vector<unique_ptr<follower_box> > boxes;
+    vector<actor_ptr> leaders;
+    for(size_t i = 0; i < followers; ++i) {
+        unique_ptr<follower_box> box(new follower_box);
+        box->config = {
+            // behaviors: follower, candidate, leader
+            nullptr, nullptr, nullptr,
+            make_pair("localhost", (uint16_t) (20000 + i)),
+            // never time out during the run
+            []() {return milliseconds(hours(1));},
+            [=](uint64_t first, uint64_t count) {
+                this_thread::sleep_for(disk);
+                return vector<bench_log_entry>(first == 0 && count ? 1 : 0,
+                                               {0});
+            },
+            [=](uint64_t, size_t, vector<bench_log_entry>) {
+                this_thread::sleep_for(disk);
+            },
+            io,
+        };
+        box->state = {1, 0, 0, 0};
+        auto config = &box->config;
+        auto state = &box->state;
+        auto raft = spawn([=]() {
+                become(follower(nullptr, *config, *state));
+            });
+        leaders.push_back(spawn(flood, raft, (uint16_t) (30000 + i)));
+        boxes.push_back(move(box));
+    }
+
+    auto lateness = make_shared<vector<int64_t> >();
+    auto beat = spawn(heartbeat, lateness);
+    self->monitor(beat);
+    receive(on(atom("DOWN"), arg_match) >> [](uint32_t) {});
+    for(auto& leader : leaders)
+        send(leader, atom("stop"));
+    await_all_others_done();
+
+    sort(begin(*lateness), end(*lateness));
+    int64_t sum = 0;
+    for(auto l : *lateness)
+        sum += l;
+    auto n = lateness->size();
+    cout << mode << "," << sched_threads << "," << (io ? io->size() : 0)
+         << "," << followers << "," << disk.count() << "," << n
+         << "," << sum / (int64_t) n << "," << (*lateness)[n / 2]
+         << "," << (*lateness)[n * 99 / 100] << "," << lateness->back()
+         << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t sched_threads = argc > 1 ? atoi(argv[1]) : 2;
+    size_t io_threads = argc > 2 ? atoi(argv[2]) : 4;
+    size_t followers = argc > 3 ? atoi(argv[3]) : 8;
+    milliseconds disk(argc > 4 ? atoi(argv[4]) : 20);
+
+    // the scheduler and the i/o pool are sized independently
+    set_default_scheduler(sched_threads);
+    announce<bench_log_entry>(&bench_log_entry::term);
+    announce_protocol<bench_log_entry>();
+
+    cout << "mode,scheduler_threads,io_threads,followers,disk_ms,samples,"
+         << "mean_late_us,p50_late_us,p99_late_us,max_late_us" << endl;
+    run("inline", sched_threads, nullptr, followers, disk);
+    run("io_pool", sched_threads, make_shared<io_pool>(io_threads),
+        followers, disk);
+    shutdown();
+}
@@ -0,0 +1,184 @@
+/// /bench_raft.cpp -- micro benchmarks for the raft hot paths
+
+/// Author: Zhang Yichao <echaozh@gmail.com>
+/// Created: 2026-10-19
+///
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <cppa/binary_deserializer.hpp>
+#include <cppa/binary_serializer.hpp>
+#include <cppa/util/buffer.hpp>
+
+#include "follower.hpp"
+#include "raft.hpp"
+
+#include "bench.hpp"
+
+using namespace std;
+using namespace cppa;
+
+typedef append_request<bench_log_entry> appreq;
+
+static const size_t batches[] = {1, 16, 256, 4096};
+
+// in memory logs, same layout as the follower tests use
+static raft_config<bench_log_entry> memory_config(
+    vector<bench_log_entry>& logs) {
+    raft_config<bench_log_entry> config;
+    config.address = make_pair("localhost", (uint16_t) 12345);
+    config.read_logs = [&](uint64_t first,
+                           uint64_t count) -> vector<bench_log_entry> {
+        if(logs.size() < first)
+            return vector<bench_log_entry>();
+        auto it = (logs.size() < first + count ? end(logs)
+                   : begin(logs) + first + count);
+        return vector<bench_log_entry>(begin(logs) + first, it);
+    };
+    config.write_logs = [&](uint64_t prev_index, size_t from,
+                            const vector<bench_log_entry>& entries) {
+        logs.resize(prev_index + 1 + entries.size());
+        copy(begin(entries) + from, end(entries),
+             begin(logs) + prev_index + 1 + from);
+    };
+    return config;
+}
+
+// an actor swallowing whatever is sent to it
+static actor_ptr spawn_sink() {
+    return spawn([]() {become(others() >> []() {});});
+}
+
+// makes a dead actor the last sender seen by this thread, which is who
+// check_peer and the follower handlers believe they are talking to.  the
+// replies they send are dropped on the spot, instead of being drained by a
+// live actor on another thread, so only the handlers themselves get timed
+static actor_ptr dead_peer() {
+    auto peer = spawn_sink();
+    self->monitor(peer);
+    send(peer, atom("EXIT"), exit_reason::user_shutdown);
+    receive(on(atom("DOWN"), arg_match) >> [](uint32_t) {});
+    return peer;
+}
+
+static void bench_check_logs() {
+    const size_t size = 4096;
+    vector<bench_log_entry> logs(size + 1, {1});
+    auto config = memory_config(logs);
+    // conflict at the head, in the middle, and none at all
+    for(auto at : {size_t(0), size / 2, size}) {
+        vector<bench_log_entry> entries(size, {1});
+        if(at < size)
+            entries[at].term = 2;
+        measure("check_logs", at, 1000, [&](size_t) {
+                bench_sink += check_logs(config.read_logs, 0, entries);
+            });
+    }
+}
+
+static void bench_follower_append(actor_ptr leader) {
+    for(auto batch : batches) {
+        vector<bench_log_entry> logs = {{0}};
+        auto config = memory_config(logs);
+        raft_state state = {1, 0, 0, 0};
+        state.peers.left.insert(
+            peer_map::left_value_type(make_pair("localhost", (uint16_t) 1),
+                                      leader));
+        auto append = follower_append(nullptr, config, state);
+        // alternate terms, so every append rewrites the whole batch
+        any_tuple reqs[] = {
+            make_any_tuple(appreq {1, 0, 0, 0,
+                        vector<bench_log_entry>(batch, {1})}),
+            make_any_tuple(appreq {1, 0, 0, 0,
+                        vector<bench_log_entry>(batch, {2})}),
+        };
+        measure("follower_append", batch, max<size_t>(100, 100000 / batch),
+                [&](size_t i) {
+                    append(reqs[i % 2]);
+                    bench_sink += state.last_index;
+                });
+    }
+}
+
+static void bench_follower_vote(actor_ptr candidate) {
+    raft_state state = {1, 0, 100, 1};
+    state.peers.left.insert(
+        peer_map::left_value_type(make_pair("localhost", (uint16_t) 1),
+                                  candidate));
+    auto vote = follower_vote(state);
+    any_tuple req = make_any_tuple(vote_request {1, 100, 1});
+    measure("follower_vote", 0, 100000, [&](size_t) {
+            vote(req);
+            bench_sink += state.term;
+        });
+}
+
+static void bench_check_peer(actor_ptr peer) {
+    for(size_t count : {1, 64, 1024}) {
+        peer_map peers;
+        vector<actor_ptr> others;
+        for(size_t i = 1; i < count; ++i) {
+            others.push_back(spawn_sink());
+            peers.left.insert(
+                peer_map::left_value_type(make_pair("localhost",
+                                                    (uint16_t) (i + 1)),
+                                          others.back()));
+        }
+        peers.left.insert(
+            peer_map::left_value_type(make_pair("localhost", (uint16_t) 1),
+                                      peer));
+        measure("check_peer", count, 100000, [&](size_t) {
+                bench_sink += check_peer(peers)->second;
+            });
+        for(auto& other : others)
+            send(other, atom("EXIT"), exit_reason::user_shutdown);
+    }
+}
+
+template <typename T>
+static void round_trip(const char* name, uint64_t param, const T& what,
+                       size_t iterations) {
+    auto type = uniform_typeid<T>();
+    util::buffer buf;
+    measure(name, param, iterations, [&](size_t) {
+            buf.clear();
+            binary_serializer bs(&buf);
+            type->serialize(&what, &bs);
+            binary_deserializer bd(buf.data(), buf.size());
+            T out;
+            type->deserialize(&out, &bd);
+            bench_sink += out.term;
+        });
+}
+
+static void bench_serialization() {
+    for(auto batch : batches)
+        round_trip("append_request_round_trip", batch,
+                   appreq {1, 0, 0, 0, vector<bench_log_entry>(batch, {1})},
+                   max<size_t>(100, 100000 / batch));
+    round_trip("append_response_round_trip", 0, append_response {1, true},
+               100000);
+    round_trip("vote_request_round_trip", 0, vote_request {1, 100, 1},
+               100000);
+    round_trip("vote_response_round_trip", 0, vote_response {1, true},
+               100000);
+}
+
+int main() {
+    announce<bench_log_entry>(&bench_log_entry::term);
+    announce_protocol<bench_log_entry>();
+
+    auto peer = dead_peer();
+
+    print_header();
+    bench_follower_append(peer);
+    bench_check_logs();
+    bench_follower_vote(peer);
+    bench_serialization();
+    bench_check_peer(peer);
+
+    await_all_others_done();
+    shutdown();
+}
@@ -7,13 +7,15 @@
 #ifndef INCLUDED_CPPA_RAFT_FOLLOWER_HPP
 #define INCLUDED_CPPA_RAFT_FOLLOWER_HPP
 
+#include <memory>
+
 #include "raft.hpp"
 
 template <typename LogEntry>
-size_t check_logs(const raft_config<LogEntry>& config, uint64_t prev_index,
-                  const std::vector<LogEntry>& entries) {
+size_t check_logs(const typename raft_config<LogEntry>::log_reader& read_logs,
+                  uint64_t prev_index, const std::vector<LogEntry>& entries) {
     auto count = entries.size();
-    auto logs = config.read_logs(prev_index + 1, count);
+    auto logs = read_logs(prev_index + 1, count);
     auto count2 = logs.size();
     assert(count2 <= count);
     for(size_t i = 0; i < count2; ++i) {
@@ -23,6 +25,41 @@ size_t check_logs(const raft_config<LogEntry>& config, uint64_t prev_index,
     return count2;
 }
 
+// the part of appending which touches the disk; runs on an i/o thread when
+// config.io is set, so it must not touch the actor's state
+template <typename LogEntry>
+static bool
+store_logs(const typename raft_config<LogEntry>::log_reader& read_logs,
+           const typename raft_config<LogEntry>::log_writer& write_logs,
+           const append_request<LogEntry>& req) {
+    auto logs = read_logs(req.prev_index, 1);
+    if(logs.empty() || logs.front().term != req.prev_term)
+        return false;
+    auto from = check_logs(read_logs, req.prev_index, req.entries);
+    write_logs(req.prev_index, from, req.entries);
+    return true;
+}
+
+template <typename LogEntry>
+static void finish_append(cppa::actor_ptr states, cppa::actor_ptr leader,
+                          raft_state& state,
+                          const append_request<LogEntry>& req,
+                          bool succeeds) {
+    using namespace std;
+    using namespace cppa;
+    if(succeeds) {
+        auto last_index = req.prev_index + req.entries.size();
+        state.last_index = last_index;
+        state.last_term = req.entries.back().term;
+        if(req.committed > state.committed) {
+            state.committed = min(req.committed, last_index);
+            // make the state machine actor apply up to the latest log
+            send(states, atom("apply_to"), state.committed);
+        }
+    }
+    send(leader, append_response {state.term, succeeds});
+}
+
 template <typename LogEntry>
 static cppa::partial_function
 follower_append(cppa::actor_ptr states, const raft_config<LogEntry>& config,
@@ -34,29 +71,46 @@ follower_append(cppa::actor_ptr states, const raft_config<LogEntry>& config,
             auto leader = check_peer(state.peers);
             if(!leader)
                 return;
-            bool succeeds = false;
-            if(req.term >= state.term) {
-                // update leader address
-                state.leader = leader;
-                if(req.term > state.term)
-                    state.term = req.term;
-                auto logs = config.read_logs(req.prev_index, 1);
-                if(!logs.empty() && logs.front().term == req.prev_term) {
-                    succeeds = true;
-                    auto from = check_logs(config, req.prev_index, req.entries);
-                    config.write_logs(req.prev_index, from, req.entries);
-                    auto last_index = req.prev_index + req.entries.size();
-                    state.last_index = last_index;
-                    state.last_term = req.entries.back().term;
-                    if(req.committed > state.committed) {
-                        state.committed = min(req.committed, last_index);
-                        // make the state machine actor apply up to the latest
-                        // log
-                        send(states, atom("apply_to"), state.committed);
-                    }
-                }
+            auto peer = self->last_sender();
+            if(req.term < state.term) {
+                send(peer, append_response {state.term, false});
+                return;
+            }
+            // update leader address
+            state.leader = leader;
+            if(req.term > state.term)
+                state.term = req.term;
+            if(!config.io) {
+                finish_append(states, peer, state, req,
+                              store_logs(config.read_logs, config.write_logs,
+                                         req));
+                return;
             }
-            send(self->last_sender(), append_response {state.term, succeeds});
+            // one copy of the request, shared by the job & the reply handler;
+            // the job also gets its own copy of the storage functions, so it
+            // may outlive the actor (and the config) without dangling
+            auto shared = make_shared<const append_request<LogEntry> >(req);
+            auto read_logs = config.read_logs;
+            auto write_logs = config.write_logs;
+            // storage throwing is reported as a failed append, and the
+            // leader will retry
+            config.io->run(self, [=]() {
+                    return make_any_tuple(atom("stored"),
+                                          store_logs(read_logs, write_logs,
+                                                     *shared));
+                }, make_any_tuple(atom("stored"), false));
+            // leave appends & votes in the mailbox until the logs are
+            // stored, they both depend on what's on the disk.  there's no
+            // election timeout meanwhile: if storage never returns, neither
+            // does the follower
+            partial_function stored = (
+                on(atom("stored"), arg_match) >> [=, &state](bool succeeds) {
+                    finish_append(states, peer, state, *shared, succeeds);
+                    unbecome();
+                });
+            become(keep_behavior,
+                   who_am_i(config.address)
+                   .or_else(handle_connections(state.peers), stored));
         });
 }
 
@@ -0,0 +1,45 @@
+#include <cassert>
+
+#include "io_pool.hpp"
+
+using namespace std;
+
+io_pool::io_pool(size_t num_threads) {
+    assert(num_threads > 0);
+    for(size_t i = 0; i < num_threads; ++i)
+        threads_.emplace_back([this]() {work();});
+}
+
+io_pool::~io_pool() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        done_ = true;
+    }
+    cond_.notify_all();
+    for(auto& t : threads_)
+        t.join();
+}
+
+void io_pool::post(function<void ()> job) {
+    {
+        lock_guard<mutex> lock(mutex_);
+        jobs_.push_back(move(job));
+    }
+    cond_.notify_one();
+}
+
+void io_pool::work() {
+    for(;;) {
+        function<void ()> job;
+        {
+            unique_lock<mutex> lock(mutex_);
+            cond_.wait(lock, [this]() {return done_ || !jobs_.empty();});
+            // drain what's queued before quitting, so no response is lost
+            if(jobs_.empty())
+                return;
+            job = move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
@@ -0,0 +1,59 @@
+/// /io_pool.hpp -- thread pool for blocking storage work
+
+/// Author: Zhang Yichao <echaozh@gmail.com>
+/// Created: 2026-10-19
+///
+
+#ifndef INCLUDED_CPPA_RAFT_IO_POOL_HPP
+#define INCLUDED_CPPA_RAFT_IO_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cppa/cppa.hpp>
+
+// with context switching disabled, an actor blocking on disk holds a
+// scheduler worker hostage; jobs posted here run on their own threads instead,
+// and report back to the actor with a message
+class io_pool {
+public:
+    explicit io_pool(size_t num_threads);
+    ~io_pool();
+    io_pool(const io_pool&) = delete;
+    io_pool& operator=(const io_pool&) = delete;
+
+    size_t size() const {return threads_.size();}
+    // job must not throw, or it takes the whole process down
+    void post(std::function<void ()> job);
+    // run job on an i/o thread, and send whatever it returns to whom; if job
+    // throws, send failed instead, so whom isn't left waiting forever.  the
+    // reply goes without a sender, as touching self here would make the pool
+    // thread an actor which keeps await_all_others_done() waiting
+    void run(cppa::actor_ptr whom, std::function<cppa::any_tuple ()> job,
+             cppa::any_tuple failed) {
+        post([=]() {
+                cppa::any_tuple reply;
+                try {
+                    reply = job();
+                } catch(...) {
+                    reply = failed;
+                }
+                whom->enqueue(nullptr, reply);
+            });
+    }
+private:
+    void work();
+private:
+    std::vector<std::thread> threads_;
+    std::deque<std::function<void ()> > jobs_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool done_ = false;
+};
+
+#endif // INCLUDED_CPPA_RAFT_IO_POOL_HPP
@@ -9,6 +9,8 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <random>
 #include <string>
 #include <utility>
@@ -18,6 +20,8 @@
 
 #include <cppa/cppa.hpp>
 
+#include "io_pool.hpp"
+
 typedef std::pair<std::string, uint16_t> address_type;
 
 template <typename LogEntry>
@@ -81,10 +85,17 @@ struct raft_config {
     std::function<cppa::behavior ()> follower, candidate, leader;
     address_type address;
     std::function<std::chrono::milliseconds ()> timeout;
-    std::function<std::vector<LogEntry> (uint64_t first,
-                                         uint64_t count)> read_logs;
-    std::function<void (uint64_t prev_index, size_t from,
-                        std::vector<LogEntry>)> write_logs;
+    typedef std::function<std::vector<LogEntry> (uint64_t first,
+                                                 uint64_t count)> log_reader;
+    typedef std::function<void (uint64_t prev_index, size_t from,
+                                std::vector<LogEntry>)> log_writer;
+    log_reader read_logs;
+    log_writer write_logs;
+    // if set, read_logs & write_logs run on these threads instead of
+    // blocking the scheduler worker the actor happens to be on.  the jobs
+    // hold copies of the two functions, so whatever they capture must stay
+    // alive until the pool is destroyed
+    std::shared_ptr<io_pool> io;
 };
 typedef boost::bimap<address_type, cppa::actor_ptr> peer_map;
 struct raft_state {
@@ -1,4 +1,6 @@
 #include <chrono>
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "test_raft.hpp"
@@ -198,6 +200,67 @@ TEST_F(FollowerTest, AppendFastLeader) {
         true, 1000, 9, concat(logs_, entries));
 };
 
+// append with storage on the i/o threads, when the previous log mismatches
+TEST_F(FollowerTest, AppendMismatchOnIoPool) {
+    config_.io = make_shared<io_pool>(1);
+    TestActor(
+        appreq{
+            1000,          // term
+                6,        // perv_index
+                2,        // prev term
+                0,        // committed
+                {{4}},
+                },
+        append_response{1000, false},
+        true, 1000);
+}
+
+// appends & votes wait in the mailbox while logs are being stored
+TEST_F(FollowerTest, AppendStashedWhileStoring) {
+    config_.io = make_shared<io_pool>(1);
+    // hold writes until we've seen nothing is answered meanwhile
+    auto gate = make_shared<promise<void> >();
+    shared_future<void> opened = gate->get_future().share();
+    auto write_logs = config_.write_logs;
+    config_.write_logs = [=](uint64_t prev_index, size_t from,
+                             vector<test_log_entry> logs) {
+        opened.wait();
+        write_logs(prev_index, from, logs);
+    };
+    spawn([=]() {
+            ReportAddress();
+            send(raft_, appreq{1000, 6, 3, 0, {{4}, {5}, {6}}});
+            send(raft_, appreq{1000, 9, 6, 0, {{7}}});
+            // granted against the logs before the appends, but not after
+            send(raft_, vote_request{1000, 8, 6});
+            auto expect_vote = [=]() {
+                Become(Quit(true), on_arg_match >> [=](vote_response resp) {
+                        EXPECT_EQ(vote_response({1000, false}), resp);
+                        EXPECT_EQ(10u, state_.last_index);
+                        EXPECT_EQ(7u, state_.last_term);
+                        Quit(true)();
+                    });
+            };
+            auto expect_append = [=](function<void ()> next) {
+                Become(Quit(true), on_arg_match >> [=](append_response resp) {
+                        EXPECT_EQ(append_response({1000, true}), resp);
+                        next();
+                    });
+            };
+            become(
+                others() >> [=]() {
+                    ADD_FAILURE() << "Answered while storing: "
+                                  << to_string(self->last_dequeued());
+                    gate->set_value();
+                    Quit(true)();
+                },
+                after(milliseconds(100)) >> [=]() {
+                    gate->set_value();
+                    expect_append([=]() {expect_append(expect_vote);});
+                });
+        });
+}
+
 // vote when candidate term is lesser
 TEST_F(FollowerTest, VoteLesserTerm) {
     TestActor(vote_request{10},            // term